@@ -206,9 +206,63 @@ class Module : Linkable
     //      getDependencyFilePath    
 };
 
+//
+// Applications that load many modules up front end up calling
+// `loadModule` in a loop, and each call parses and checks the
+// module (and any of its imports not yet loaded) on the calling
+// thread. Much of that work is independent, so we also allow
+// a batch of modules to be loaded in one call:
+//
+
+extension Session
+{
+    // Load all of the named modules, returning them in
+    // `outModules` in the same order as `names`.
+    //
+    // Diagnostics for all of the modules are reported in
+    // a single blob. If any module fails to load, the
+    // corresponding entry in `outModules` is null, but
+    // the other modules are still loaded.
+    //
+    // Returns `SLANG_OK` only if every module loaded. If
+    // some (or all) modules failed, returns `SLANG_FAIL`,
+    // and the application checks `outModules` to see which
+    // ones did load. Other errors (e.g., invalid arguments)
+    // are reported before any module is loaded, in which
+    // case every entry of `outModules` is null.
+    //
+    SlangResult loadModules(
+        Count               count,
+        const char* const*  names,
+        Module**            outModules,
+        IBlob**             outDiagnostics = nullptr);
+}
+
+//
+// The benefit of a batch call is that the implementation gets
+// to see the whole set of work at once. It can parse all of the
+// named modules, discover their `import`s, and build a graph of
+// dependencies before any semantic checking happens. Parsing
+// and checking can then proceed in parallel for any modules
+// whose dependencies are already checked, with each module
+// (including shared dependencies) being loaded exactly once.
+//
+// The result is required to be the same as calling `loadModule`
+// for each name in order; in particular, the order in which
+// diagnostics are reported must not depend on how the work
+// happened to be scheduled.
+//
+// Getting there requires semantic checking of distinct modules
+// to be able to run concurrently within a `Session`, which
+// the current implementation does not support (e.g., because
+// of shared caches of specialized types). The API can be
+// provided before that work is done, by simply loading the
+// modules in dependency order on one thread.
+//
+
 //
 // Astute readers might have already guessed that the `Linkable`
-// base class there corresponds to the current `IComponentType`
+// base class of `Module` corresponds to the current `IComponentType`
 // interface.
 //
 // The most notable feature of a `Linkable` is that it can
@@ -305,6 +359,88 @@ class Entity
 // Note that `Module` above already serves the role of both `IModule`
 // and a `DeclReflection` for the module.
 //
+// The name queries on `Entity` above return `const char*`s,
+// which is convenient but hides a cost. A fully-qualified
+// name has to be *built*, by walking up through the parents
+// of an entity and printing any generic arguments. Tools
+// that use names as keys (e.g., to match shader types up
+// with application types) end up doing that work, and then
+// hashing and comparing the resulting strings, over and over.
+//
+// To support such tools, the same names can also be queried
+// as handles into a table of names that is shared by the
+// whole `Session`:
+//
+
+struct Name
+{
+    // The text of the name. The returned pointer is valid for
+    // as long as the `Session` that owns the name.
+    //
+    const char* getText();
+
+    // Two `Name`s from the same `Session` are equal if and only
+    // if their text is equal, so comparison and hashing only
+    // need to look at the handle itself.
+    //
+    bool operator==(Name other);
+    HashCode getHashCode();
+
+    // A default-constructed `Name` is the *null* name, which is
+    // not equal to any name that has text (including the empty
+    // string), and whose `getText()` returns null.
+    //
+    bool isNull();
+};
+
+extension Entity
+{
+    Name getNameHandle();
+    Name getSimpleNameHandle();
+    Name getFullyQualifiedNameHandle();
+}
+
+extension Session
+{
+    // Get the `Name` for the given text, so that application
+    // strings can be compared against entity names without
+    // going through `strcmp`. If the text has not been seen
+    // before, it is interned, and stays in the session's
+    // table for the lifetime of the session.
+    //
+    Name getName(const char* text);
+
+    // Look up the `Name` for the given text *without* interning
+    // it. Returns the null `Name` if the text has never been
+    // interned in this session.
+    //
+    Name findName(const char* text);
+}
+
+//
+// On the implementation side, the compiler already interns
+// the simple names of declarations, so `getSimpleNameHandle()`
+// is just a lookup. The fully-qualified name of an entity is
+// built the first time it is requested, interned, and then
+// cached on the entity. The `const char*` queries on `Entity`
+// are then just `getText()` on the corresponding handle, and
+// so they return stable pointers instead of fresh strings.
+//
+// Names may be requested from more than one thread at once
+// (layout, for one, needs fully-qualified names for its
+// structural hashes, as described in a later document). The
+// per-entity cache is therefore filled with the publish-once
+// approach described for concurrent reads in that document,
+// and the session's name table is guarded by a lock of its own,
+// which is held only for a single lookup-or-insert. That lock
+// is separate from the per-session lock that serializes semantic
+// checking (see `specializeProgramAsync` below), so interning a
+// name never waits for checking to finish.
+//
+// Note that caching per-entity only pays off if asking for
+// the same specialized entity twice yields the same object.
+// We will come back to that when we discuss `Generic::specialize`.
+//
 
 class Func : public Entity
 {
@@ -337,6 +473,99 @@ class AggType : Type
     Index findFieldIndexByName(char const* name);
 };
 
+//
+// Both `AggType::findFieldIndexByName` and `Entity::findChild`
+// are lookups by name, and the obvious implementation of each
+// is a linear scan. That is fine for hand-written types, but
+// generated `struct`s with thousands of fields (or the core
+// module, with thousands of children) are not rare.
+//
+// Lookups by name should instead go through an index that
+// is built lazily, the first time an entity is asked to look
+// up one of its children (or fields), and then kept alongside
+// the entity. Because simple names are interned, the index
+// can be keyed on `Name` handles rather than strings, and
+// we expose overloads that take a `Name` directly so that
+// callers doing many lookups can skip hashing the text:
+//
+
+extension Entity
+{
+    Entity* findChild(Name name);
+}
+
+extension AggType
+{
+    Index findFieldIndexByName(Name name);
+}
+
+//
+// The `char const*` forms remain, and just map the text to
+// a `Name` with `Session::findName` before using the index.
+// If `findName` returns the null `Name`, then no declaration
+// anywhere in the session has that name, and the lookup fails
+// without touching the index at all. Using `findName` rather
+// than `getName` also means that probing for names that don't
+// exist does not grow the session's name table.
+//
+// Note that a declaration can have more than one child with
+// the same name (e.g., overloaded functions), so the index
+// maps a name to the *first* such child, matching what a
+// linear scan would find.
+//
+// Enumeration of children has a related problem. So far we
+// have been vague about what a `Sequence<T>` actually is,
+// but for `getChildren()` it matters: if every call builds
+// an array of freshly-created child `Entity`s, then walking
+// an entire module (let alone the core module) allocates
+// a wrapper for every node in the tree before the walk has
+// even started.
+//
+// The `Sequence<T>` returned by `getChildren()` should thus
+// be a *lazy* cursor over the underlying declarations, which
+// only creates the `Entity` for a child when the cursor
+// reaches it. Iterating a sequence does not allocate beyond
+// the entities it yields.
+//
+// Most walks are only interested in some kinds of children
+// (e.g., only the functions, or only the `struct` types),
+// and it is wasteful to create an `Entity` just so that the
+// application can cast it and throw it away. We therefore
+// allow the kind of children to be filtered up front:
+//
+
+enum class EntityKind
+{
+    // The kinds form a hierarchy that mirrors the classes in
+    // this document, and filtering by a kind includes all of
+    // the kinds nested under it (e.g., filtering by `Type`
+    // also yields `StructType`s).
+    //
+    Func,
+    Type,
+        AggType,
+            StructType,
+            ClassType,
+            InterfaceType,
+        // ...
+    Var,
+    Generic,
+    // ...
+};
+
+extension Entity
+{
+    Sequence<Entity*> getChildren(EntityKind kind);
+}
+
+//
+// Because the filtering is done on the underlying declarations,
+// children that don't match are skipped without ever being
+// wrapped. This is also a natural place for the `enum` tag
+// that the real API would need for casting (see the notes
+// at the top of this document).
+//
+
 class StructType : AggType {};
 class ClassType : AggType {};
 class InterfaceType : AggType {};
@@ -432,6 +661,97 @@ class Generic : public Entity
     Entity* getUnspecializedInnerEntity();
 };
 
+//
+// Specializing the same generic to the same arguments should
+// yield the *same* `Entity`, and not just an equivalent one.
+// This matters for more than just avoiding redundant semantic
+// checking: anything that is cached on an entity (such as the
+// fully-qualified name discussed earlier) is only shared if
+// the entity itself is shared.
+//
+// The session thus keeps a cache of specializations, keyed on
+// the generic along with its arguments, and `specialize` only
+// does semantic checking on a miss. Because the arguments are
+// themselves `Entity`s (which are shared in the same way, all
+// the way down), the key can compare arguments by identity.
+// Entries are dropped when any module they refer to is released
+// (see the discussion of lifetimes in a later document), so the
+// cache does not grow without bound as modules are reloaded.
+//
+// The compiler already hash-conses `DeclRef`s and `Type`s
+// internally, so much of this is about making sure that the
+// reflection API doesn't defeat that by creating a new wrapper
+// object for each query.
+//
+// Applications that rely on this reuse for performance will
+// want to confirm that it is happening, so the session exposes
+// counters for the cache:
+//
+
+struct SpecializationCacheStats
+{
+    Count hitCount;
+    Count missCount;
+};
+
+extension Session
+{
+    SpecializationCacheStats getSpecializationCacheStats();
+}
+
+//
+// Note that a specialization that fails is *not* cached,
+// so that calling `specialize` again reports the same
+// diagnostics rather than a silent null.
+//
+// Some applications specialize a single generic to many
+// different sets of arguments at once (e.g., one per
+// material variant). For those cases, a batch form of
+// `specialize` is provided:
+//
+
+extension Generic
+{
+    // Specialize this generic to `tupleCount` sets of arguments,
+    // each consisting of `argCount` entities. The arguments
+    // are passed as a single contiguous array, with the
+    // arguments for tuple `i` starting at `args[i*argCount]`.
+    //
+    // The results are written to `outEntities[i]`, which is
+    // null for any tuple that failed to specialize. If
+    // `outDiagnostics` is non-null, it must point to an array
+    // of `tupleCount` blob pointers, one per tuple.
+    //
+    // Returns `SLANG_OK` only if every tuple specialized
+    // successfully. If some (or all) tuples failed, returns
+    // `SLANG_FAIL`; the other tuples are still specialized,
+    // and the application checks `outEntities` to see which
+    // ones succeeded.
+    //
+    SlangResult specializeMany(
+        Count           tupleCount,
+        Count           argCount,
+        Entity* const*  args,
+        Entity**        outEntities,
+        ISlangBlob**    outDiagnostics = nullptr);
+}
+
+//
+// Each result is the same `Entity` that `specialize` would have
+// returned for that tuple, and all of the results go through
+// the same specialization cache.
+//
+// The main reason for a batch form is that much of the work of
+// checking a specialization doesn't depend on the arguments
+// (e.g., looking up the generic's constraints and the members
+// that need to be specialized), and can be done once for the
+// whole batch. Checking that each tuple satisfies the
+// constraints is independent across tuples, and could in
+// principle run on multiple threads, but as with `loadModules`
+// that depends on semantic checking becoming safe to run
+// concurrently, and the API does not promise it.
+//
+
 //
 // Aside: There is a *lot* of possible design space here
 // for how generic-ness is exposed to users. The compiler
@@ -498,6 +818,28 @@ extension Session
     StringConstant* getStringConstant(char const* text);
 }
 
+//
+// These operations return *canonical* constants: calling
+// `getIntConstant` twice with the same type and value
+// returns the same `IntConstant`, so that pointer equality
+// of constants means equality of their values.
+//
+// This is what allows the specialization cache described
+// above to compare arguments by identity, even when some
+// of those arguments are values (e.g., the size of an array)
+// rather than types.
+//
+// For floating-point constants, "the same value" means the
+// same bit pattern, so `0.0` and `-0.0` are distinct
+// constants, while two NaNs with the same bits are not.
+// This matches how the compiler already treats them when
+// deciding if two specializations are the same.
+//
+// String constants are canonicalized on their contents, and
+// the returned `StringConstant` holds its own copy of the text,
+// so it does not depend on the lifetime of `text`.
+//
+
 //
 // With that `Value` hierarchy established, we can
 // then expose user attributes:
@@ -517,6 +859,60 @@ extension Entity
     Sequence<UserAttribute> getUserAttributes();
 }
 
+//
+// Representing attribute arguments as `Value`s is fully general,
+// but in practice almost every argument is an integer, float,
+// string, or type. An application processing attributes in bulk
+// shouldn't need to cast each argument to find out which, so
+// attributes also expose their arguments in decoded form:
+//
+
+enum class AttributeArgKind
+{
+    Int,
+    Float,
+    String,
+    Type,
+    Other,  // anything else; use `getArgs()` to inspect it
+};
+
+struct AttributeArg
+{
+    AttributeArgKind    kind;
+    union
+    {
+        Int64           intValue;
+        Float64         floatValue;
+        struct
+        {
+            char const* text;
+            Size        size;
+        }               stringValue;
+        Type*           typeValue;
+    };
+};
+
+extension Attribute
+{
+    // Returns the arguments of this attribute, where entry `i`
+    // corresponds to `getArgs()[i]`. Unlike most sequences in
+    // this document, this one is guaranteed to be a contiguous
+    // array, so the application can get the pointer and count
+    // from one call and walk the arguments directly, without
+    // touching the `Value`-based `getArgs()` at all.
+    //
+    Sequence<AttributeArg> getDecodedArgs();
+}
+
+//
+// The decoded arguments are produced when the attribute is checked
+// (which is when the compiler already works out their values), and
+// stored alongside it, so `getDecodedArgs()` does no work of its own.
+// String arguments point at the same storage as the corresponding
+// canonical `StringConstant`, and so remain valid for as long as
+// the attribute itself.
+//
+
 //
 // In order for users to be able to query the constraints
 // on generic parameters, we need a representation of
@@ -588,7 +984,9 @@ class Program
     Sequence<EntryPoint*> getEntryPoints();
     EntryPoint* findEntryPoint(const char* name);
 
-    Entity* findEntity(const char* name);
+    Entity* findEntity(
+        const char* name,
+        IBlob**     outDiagnostics = nullptr);
 };
 
 //
@@ -616,6 +1014,203 @@ class Program
 // of `Entity`s needing to refer to implementation-side
 // objects from disjoint class hierarchies...)
 //
+// Because `findEntity` has to parse and check `name` as a type
+// expression (e.g., `Outer<int>.Inner`), it is far more costly
+// than the other lookups in this document. Applications tend
+// to call it with a small, fixed set of strings, so a `Program`
+// caches the result for each name it has been asked to find.
+//
+// The cache is first consulted with the string exactly as given,
+// so a repeated call costs one hash of the string and one lookup,
+// with no parsing. Only on a miss is the name parsed and put in
+// a normalized form, which is then looked up in turn, so that
+// strings that differ only in whitespace still share a resolved
+// `Entity` (and the raw string is added as an alias for it).
+//
+// Since the raw strings come from the application, the number of
+// aliases kept per program is capped; past the cap, a miss on the
+// raw string simply falls back to parsing. Failed lookups are not
+// cached, so that they report their diagnostics (through
+// `outDiagnostics`) every time.
+//
+// An application that wants to avoid even the hashing of the
+// string can instead resolve a name once, up front, to a
+// query handle:
+//
+
+class EntityQuery
+{
+    Entity* find(
+        Program*    program,
+        IBlob**     outDiagnostics = nullptr);
+};
+
+extension Session
+{
+    EntityQuery* createEntityQuery(
+        const char* name,
+        IBlob**     outDiagnostics = nullptr);
+}
+
+//
+// An `EntityQuery` holds the *parsed* form of the name, and
+// so any syntax errors are reported when it is created. It is
+// not tied to a single `Program`, since the same query may be
+// used with many programs that link the same modules.
+//
+// The first call to `find` for a given program does the lookup,
+// and caches the result *on the program*, in a table keyed by
+// the query. Later calls with the same program just return the
+// cached `Entity`. A lookup that fails (e.g., because the name
+// does not resolve in that program) is not cached, and reports
+// its errors through `outDiagnostics` on each call; syntax errors
+// were already reported when the query was created, so they never
+// show up here. Keeping the cache on the program (rather than
+// on the query, keyed by `Program*`) ties each cached result to
+// the lifetime of the program it came from: when the program is
+// released its entries go with it, so a new program that happens
+// to reuse the same address can never see a stale `Entity`. The
+// table is keyed by a serial number assigned to each query when
+// it is created, rather than by its address, for the same reason.
+// Its size is bounded by the number of distinct queries used with
+// that program, which the application controls.
+//
+// Linking the Same Thing Repeatedly
+// ---------------------------------
+//
+// Applications often `compose` and `link` the same set of
+// modules, entry points, and type conformances many times
+// over (e.g., once per frame, or once per tool invocation).
+// Linking is not free, and doing it again for identical
+// inputs is wasted work.
+//
+// Every `Linkable` can report a hash of its contents:
+//
+
+struct ContentHash
+{
+    UInt64 low;
+    UInt64 high;
+};
+
+extension Linkable
+{
+    // The hash covers the source of any modules involved
+    // (and of their dependencies), the compiler options that
+    // affect checking, and, for a composite, the hashes of
+    // its components in order.
+    //
+    ContentHash getContentHash();
+}
+
+//
+// (Computing the hash is cheap once a module is loaded, since
+// the hash of a module's source is computed during loading and
+// stored, and the hash of each `Linkable` is cached on it. The
+// hash is returned by value, so querying it allocates nothing.)
+//
+// Within a session, `link` keeps a cache of linked programs, so
+// that linking the same inputs a second time returns the *same*
+// `Program`, at the cost of one lookup. This cache is keyed on
+// the *identity* of the inputs, not on their content hash: the
+// key is the sequence of component objects being linked (each
+// identified by a serial number assigned when it is created, so
+// that a reused address cannot cause a false hit), together with
+// the options that affect linking.
+//
+// Keying on content alone would be wrong here. If a module `A`
+// is reloaded as `A'`, and then reverted to its original source
+// as `A''`, a program linked from `A''` has the same content hash
+// as one linked from `A`, but it must still refer to `A''` and
+// its `Entity`s; handing back the old program would break the
+// rule that an `Entity` found through a program belongs to that
+// program's modules, and `ModuleReload::affects` and
+// `Program::update` (below) would give wrong answers about it.
+// The content hash is used only for the persistent cache
+// described next, whose entries hold linked IR rather than
+// objects tied to particular modules.
+//
+// The cache holds its programs *weakly*: an entry does not keep
+// its `Program` alive, and is removed when the application
+// releases the last reference to the program. The cache thus
+// never holds more programs than the application itself does,
+// and a long-running session doesn't accumulate every program
+// it has ever linked. Relinking after a program has been
+// released does the full link again (or consults the persistent
+// cache below, if one has been provided).
+//
+// A linked `Program` refers to the `Module`s it was linked
+// from, so it cannot be meaningfully shared across processes.
+// What *can* be shared is the linked IR that `link` produces,
+// which is most of the cost. An application that wants to
+// persist that work can provide its own storage:
+//
+
+class ILinkCache
+{
+    // Returns the blob previously stored for `hash`, if any.
+    //
+    SlangResult load(ContentHash hash, IBlob** outLinkedIR);
+    SlangResult store(ContentHash hash, IBlob* linkedIR);
+};
+
+extension Session
+{
+    void setLinkCache(ILinkCache* cache);
+}
+
+//
+// We deliberately leave the storage (a directory on disk, a
+// shared network cache, etc.) to the application, rather than
+// having Slang write files on its own. As with the layout
+// snapshots described in a later document, a stored blob
+// records the compiler version that produced it, and a blob
+// from a different version is treated as a miss.
+//
+// Finding Entities by Attribute
+// -----------------------------
+//
+// Many engines use user attributes to drive their own policies
+// (e.g., marking parameters as `[PerFrame]` so they can be bound
+// automatically). Finding every entity with a given attribute
+// currently means walking every entity in the program and calling
+// `getUserAttributes()` on each, which is a lot of work for a
+// question that has a small answer.
+//
+// A `Program` can instead answer that question directly:
+//
+
+struct AttributeUse
+{
+    Entity*         entity;
+    UserAttribute   attribute;
+};
+
+extension Program
+{
+    // Returns every use of a user attribute with the given name
+    // on an entity in the program's linked modules, in the order
+    // the entities appear in their modules.
+    //
+    Sequence<AttributeUse> findAttributeUses(Name attributeName);
+    Sequence<AttributeUse> findAttributeUses(const char* attributeName);
+}
+
+//
+// The first query on a program builds an index, mapping each
+// attribute name to all of its uses, in a single walk over the
+// declarations of the linked modules; every later query is a
+// lookup. The index is built at the AST level, where attributes
+// actually live, so it does not create an `Entity` for anything
+// that doesn't carry a user attribute.
+//
+// Note that the entities found this way are *unspecialized*.
+// A field of a generic `struct` carries the same attributes
+// in every specialization, so the index cannot enumerate
+// specializations that have never been requested. Applications
+// that care about layout will usually want the query on
+// `ProgramLayout` described below instead.
+//
 
 
 //
@@ -769,6 +1364,89 @@ class EntryPointLayout : VarLayout
 // Similar to the case with `ProgramLayout`, the latter case for
 // `EntryPointLayout` indicates that the entry point needed an
 // implicit constant buffer to be allocated for its parameters.
+//
+// The attribute index on `Program` has a layout-level counterpart,
+// which finds the *laid out* variables that carry an attribute.
+// Because the field `VarLayout`s of a `struct` type are shared by
+// every parameter of that type (and only hold offsets relative to
+// the `struct`), a bare `VarLayout*` can't say *where* a hit is.
+// Each result instead records the path to the variable and its
+// accumulated offsets, like the leaf field table described in
+// the next document:
+//
+
+struct AttributedVarInfo
+{
+    UserAttribute   attribute;
+
+    // The (relative) layout of the variable carrying the attribute.
+    //
+    VarLayout*      varLayout;
+
+    // The index of the entry point whose parameter this is, or
+    // `-1` for a global parameter (as in `LayoutChange`, in a
+    // later document).
+    //
+    Index           entryPointIndex;
+
+    // The path to the variable, starting from the global scope
+    // (or from the parameters of entry point `entryPointIndex`).
+    // The first entry is the index of the global (or entry-point)
+    // parameter, and each later entry is a field index, or
+    // `kAnyArrayElement` for a step into the element type of an
+    // array.
+    //
+    Sequence<Index> path;
+
+    // Offsets and spaces accumulated along `path`, starting from
+    // the `ProgramLayout` (or the `EntryPointLayout`), following
+    // the same rules as `TypeLayout::getLeafFields()`. For a
+    // path that steps through arrays, these are the offsets for
+    // element zero of each array.
+    //
+    Offset          getOffset(LayoutResourceKind kind);
+    Index           getBindingSpace(LayoutResourceKind kind);
+};
+
+static const Index kAnyArrayElement = -1;
+
+extension ProgramLayout
+{
+    // Returns every shader parameter (global or entry-point), or
+    // field (at any depth) of a shader parameter, whose variable
+    // carries a user attribute with the given name. Global
+    // parameters come first, followed by the parameters of each
+    // entry point in order.
+    //
+    Sequence<AttributedVarInfo> findVarLayoutsWithAttribute(Name attributeName);
+    Sequence<AttributedVarInfo> findVarLayoutsWithAttribute(const char* attributeName);
+}
+
+//
+// Unlike the `Program` query, this one sees specialized fields,
+// since it walks the actual layouts. The walk is like the one for
+// `getLeafFields()`, except that it also descends into the element
+// type of arrays, once per array rather than once per element, so
+// that a `[PerFrame]` field inside an array of `struct`s is found.
+// Such a result has a `kAnyArrayElement` step in its path; to get
+// the location of the field in element `i` of the array, the
+// application applies the array-element rules from the next
+// document (e.g., adding `i` times the array's stride in `Bytes`).
+// An attribute on the array variable itself is reported for the
+// array as a whole, as usual.
+//
+// The results are computed once and cached on the `ProgramLayout`.
+// The `const char*` form looks the name up with `Session::findName`,
+// and returns an empty sequence if it has never been interned.
+//
+// A `ProgramLayout` opened from a `LayoutSnapshot` has no `Session`
+// to intern names in. There, the index is keyed on the text of
+// the attribute names (as stored in the snapshot's string table),
+// and is built in the snapshot's side table the first time it is
+// queried. The `const char*` form looks up the text directly, and
+// the `Name` form looks up `attributeName.getText()`, so both give
+// the same results as they would on the original program.
+//
 
 
 // Target-Specialized Programs
@@ -795,6 +1473,120 @@ class Target
 // TODO: Is there ever a reason to query layout for something other
 // than a type?
 //
+// The layout of a type depends only on the type, the target, and
+// the layout rules being applied. When many programs use the same
+// `struct` type (as is typical across permutations of a shader),
+// computing and storing its layout separately for each of them is
+// wasted time and memory.
+//
+// A `Target` thus keeps a cache of type layouts, keyed on the type
+// (an `Entity`, which is already shared, per the discussion of
+// specialization above) along with the `LayoutRules`. Both
+// `getEntityLayout` and `specializeProgram` go through this cache,
+// so that the `TypeLayout` for a given type under given rules is
+// computed once per target, and the *same* `TypeLayout` object is
+// returned by every query and referenced by every program that
+// needs it.
+//
+// Only layouts that really are independent of the program can be
+// shared this way. The `VarLayout`s for a program's parameters,
+// which carry that program's binding assignments, belong to the
+// program. Types whose layout depends on how the program is linked
+// (e.g., a `struct` with a field of interface type, whose layout
+// depends on the type conformances linked into the program) are
+// not shared either.
+//
+// Shared layouts are owned by the `Target`, but they must not
+// simply live as long as it does: every reload of a module (see
+// "Reloading Modules" below) creates new `Entity`s, and so new
+// cache keys, and an editor that keeps a `Target` around across
+// many reloads would otherwise accumulate layouts for every old
+// version of every type.
+//
+// The cache is therefore organized by module. Each entry belongs
+// to one of the modules that its type refers to (including through
+// generic arguments): the one that comes *last in import order*.
+// If one of those modules (transitively) imports all of the others,
+// it is the owner; in general, the modules are ordered so that
+// each comes after everything it imports, and modules with no
+// import relationship are ordered by name. This choice depends
+// only on the modules themselves, and not on the order in which
+// they were loaded, so concurrent calls to `loadModules` can't
+// change it. (Because a module keeps the modules it imports
+// alive, the module last in import order is also one that is
+// released no later than the others, so its arena is freed as
+// soon as possible.) The `Target` keeps a separate arena of
+// layouts for each module. When a module is
+// released, the `Target` drops that module's entries and frees its
+// arena. An entry is also removed from the cache (so it can no
+// longer be found) as soon as *any* module it refers to is released;
+// its memory is reclaimed along with the arena it was allocated in.
+//
+// Every `Program` keeps the modules it was linked from alive, and
+// every `TargetProgram` keeps its `Program` and `Target` alive, so
+// a module's layouts cannot be freed while a program that uses
+// them still exists. This preserves the rule (in a later document)
+// that any layout reachable from a `TargetProgram` stays valid as
+// long as the program does.
+//
+// An `EntityLayout*` returned directly by `getEntityLayout` (or by
+// `getEntityLayouts`, below) is not reachable from any program, and
+// is not reference-counted. It stays valid as long as both the
+// `Target` and the `Entity` it was computed for do; that is, as
+// long as the `Target` is alive and every module the entity refers
+// to is still loaded. (A layout that can't be shared, as described
+// above, is allocated in the owning module's arena all the same,
+// but is not entered into the cache.) An application that wants
+// to keep such a layout around must keep those modules alive,
+// typically by holding on to a `Program` linked from them.
+//
+// Tools that need layouts for many types (e.g., to generate
+// application-side declarations for every type under several
+// different `LayoutRules`) can request them in a batch:
+//
+
+struct LayoutRequest
+{
+    Entity*     entity;
+    LayoutRules rules;
+};
+
+extension Target
+{
+    // Compute the layout for each of the `count` requests, writing
+    // the result for `requests[i]` to `outLayouts[i]` (or null, if
+    // that entity could not be laid out).
+    //
+    SlangResult getEntityLayouts(
+        Count                   count,
+        LayoutRequest const*    requests,
+        EntityLayout**          outLayouts,
+        IBlob**                 outDiagnostics = nullptr);
+}
+
+//
+// Each result is the same object that `getEntityLayout` would have
+// returned for that request. Because all of the requests go through
+// the target's layout cache, any sub-layouts they have in common
+// (e.g., a `struct` used as a field in many of the requested types)
+// are computed only once.
+//
+// Unlike semantic checking, computing layout for types that have
+// already been checked never changes the AST, so the implementation
+// can spread the requests across multiple threads, as long as the
+// layout cache itself uses the publish-once approach described for
+// concurrent reads in a later document. If two threads race to lay
+// out the same sub-type, one result is discarded, and both requests
+// end up referring to the one that was installed.
+//
+// Layout does write to one piece of session state: computing the
+// structural hash of a type layout needs the fully-qualified names
+// of the types involved, which may be interned for the first time
+// along the way. That goes through the name table's own lock, as
+// described for `Name`s above, and so threads doing layout may
+// briefly contend on it with each other (or with the application),
+// but never wait on semantic checking.
+//
 // A `TargetEntryPoint` is just an `EntryPointLayout` plus the ability
 // to query the compiled kernel code for the given entry point:
 //
@@ -822,6 +1614,209 @@ class TargetProgram : public ProgramLayout
     TargetEntryPoint* findEntryPoint(EntryPoint* entryPoint);
 };
 
+// Reloading Modules
+// -----------------
+//
+// An application that supports hot-reload of shaders currently
+// has to throw away its entire `Session` when a single source
+// file changes, and then reload every module and re-create
+// every program. Most of that work recomputes exactly what
+// was there before.
+//
+// Instead, a session can be asked to reload specific modules:
+//
+class ModuleReload
+{
+    // The modules that were re-checked: those whose source
+    // changed, plus any modules that (transitively) import
+    // one of them. Each reloaded module is a *new* `Module`;
+    // the old one remains valid, but is no longer what
+    // `loadModule` will return.
+    //
+    Sequence<Module*> getReloadedModules();
+
+    // Does the given program (transitively) depend on any
+    // of the modules that were reloaded?
+    //
+    bool affects(Program* program);
+};
+
+extension Session
+{
+    ModuleReload* reloadModules(
+        Count               count,
+        const char* const*  names,
+        IBlob**             outDiagnostics = nullptr);
+}
+
+//
+// Programs and target programs are not updated in place,
+// since applications may still be using the old ones (e.g.,
+// for pipelines that are in flight). Instead, an application
+// asks for an updated version of each program it cares about:
+//
+extension Program
+{
+    // Returns a program linked from the same components as
+    // this one, with any reloaded modules substituted in.
+    // If the program is not affected by the reload, this
+    // just returns the program itself.
+    //
+    Program* update(ModuleReload* reload, IBlob** outDiagnostics = nullptr);
+}
+
+extension Target
+{
+    // Returns the result of specializing the updated program
+    // to this target, or `oldProgram` itself if the reload
+    // did not affect it.
+    //
+    TargetProgram* updateProgram(
+        TargetProgram*  oldProgram,
+        ModuleReload*   reload,
+        IBlob**         outDiagnostics = nullptr);
+}
+
+//
+// Finally, even when a program *is* affected by a reload,
+// most edits don't change the layout of most entry points.
+// An application that builds one pipeline per entry point
+// needs to know which of them actually changed:
+//
+extension TargetProgram
+{
+    // Returns the entry points of this program whose layout
+    // differs from that of the matching entry point in
+    // `previous` (or that have no match in `previous`).
+    //
+    Sequence<TargetEntryPoint*> getEntryPointsChangedSince(
+        TargetProgram* previous);
+}
+
+//
+// Note that this only compares *layout*. An edit that only
+// changes the body of a function changes the compiled code
+// of an entry point, but not its layout, so the application
+// still needs to re-fetch code with `getCode()`; it just
+// doesn't need to rebuild its pipeline layouts.
+//
+// Specializing Asynchronously
+// ---------------------------
+//
+// `Target::specializeProgram` does all of layout and code generation
+// before it returns, which can take long enough to stall an editor's
+// UI thread or a streaming loader. Applications can instead start
+// specialization and collect the result later:
+//
+enum class TaskPriority
+{
+    Low,
+    Normal,
+    High,
+};
+
+class SpecializeProgramTask
+{
+    // Has the task finished (successfully, with an error, or
+    // by being cancelled)?
+    //
+    bool isDone();
+
+    // Block until the task has finished, and then return its
+    // result. The result is null if specialization failed or
+    // was cancelled.
+    //
+    TargetProgram* wait(IBlob** outDiagnostics = nullptr);
+
+    // Request that the task stop as soon as possible. This does
+    // not block; a cancelled task finishes (with a null result)
+    // at the next point where the compiler checks for cancellation.
+    //
+    void cancel();
+
+    // Change the priority of a task that has not yet started.
+    // This only has an effect for tasks running on Slang's own
+    // thread pool; once a task has been handed to an application
+    // `IExecutor` via `submit`, its priority is up to that executor
+    // and `setPriority` does nothing.
+    //
+    void setPriority(TaskPriority priority);
+};
+
+//
+// The work for a task runs on an *executor*. By default, Slang
+// uses a pool of threads that it manages itself, but applications
+// that already have a job system will want to supply their own:
+//
+class IExecutor
+{
+    // Run `callback(context)` at some point in the future, on
+    // any thread. The priority is a hint.
+    //
+    void submit(
+        void            (*callback)(void* context),
+        void*           context,
+        TaskPriority    priority);
+};
+
+extension Target
+{
+    SpecializeProgramTask* specializeProgramAsync(
+        Program*        program,
+        TaskPriority    priority = TaskPriority::Normal,
+        IExecutor*      executor = nullptr);
+
+    // The asynchronous form of `updateProgram`. The task first
+    // relinks the program with `Program::update`, and then
+    // specializes the result. If the reload does not affect
+    // `oldProgram`, the task is already done when it is returned,
+    // and its result is `oldProgram` itself.
+    //
+    SpecializeProgramTask* updateProgramAsync(
+        TargetProgram*  oldProgram,
+        ModuleReload*   reload,
+        TaskPriority    priority = TaskPriority::Normal,
+        IExecutor*      executor = nullptr);
+}
+
+//
+// Cancellation is cooperative: the compiler checks for it between
+// passes (and between entry points during code generation), rather
+// than at arbitrary points. That keeps the implementation simple,
+// while still making it cheap to abandon work that has been
+// superseded, such as a hot-reload request for a file that has
+// since been edited again: the application cancels the task from
+// `updateProgramAsync` for the old edit, and starts a new one.
+//
+// A task holds a reference to its `Program` (and the `Target`), so
+// the application does not need to keep them alive separately.
+// The `TargetProgram` it produces is exactly what the synchronous
+// `specializeProgram` would have returned, and the same rules for
+// concurrent reads apply to it once `wait` returns.
+//
+// The application may keep using the `Session` while tasks run:
+// calling `loadModule`, `reloadModules`, `Generic::specialize`,
+// `link`, and so on from any thread is allowed. Layout and code
+// generation only read modules that have already been checked
+// (which never change afterward, since a reload creates new
+// modules). The shared state they do write is limited to the
+// target's layout cache and the per-entity name caches (both of
+// which use publish-once updates), and the session's name table,
+// when a fully-qualified name is interned for a structural hash.
+// The name table has a lock of its own, held only for a single
+// lookup-or-insert, so layout and code generation never take the
+// per-session lock described below, and never wait for checking.
+//
+// The only part of a task that needs the per-session lock is the
+// relink at the start of an `updateProgramAsync` task. Since
+// session-level work cannot yet run concurrently (as discussed
+// for `loadModules`), operations that mutate the session are
+// serialized by a per-session lock, which that relink also takes.
+// An application call may thus briefly wait for a task's relink
+// to finish (and vice versa), but never for layout or code
+// generation, which is where nearly all of the time goes.
+//
+
 //
 // We've covered a lot of API surface area and yet we haven't
 // actually gotten to stuff like layout information, bindings,
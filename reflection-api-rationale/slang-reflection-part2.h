@@ -377,9 +377,278 @@ class ParameterGroupTypeLayout : public TypeLayout
     VarLayout*          getContainerVarLayout();
 };
 
-// TODO: when *not* to accumulate
+//
+// Accumulating Spaces
+// -------------------
+//
+// So far we have only talked about accumulating the *index*
+// part of an offset (a byte offset, or a `register`/`binding`).
+// On D3D12 and Vulkan, a bindable resource also needs a `space`
+// or `set`, and that needs to be accumulated along the chain as
+// well.
+//
+// For each resource kind, a variable layout records a space
+// offset alongside its index offset:
+//
+extension VarLayout
+{
+    Index getBindingSpace(LayoutResourceKind kind);
+}
+//
+// (The `getBindingSpace()` query shown earlier is just this
+// query, for the single resource kind the variable consumes.)
+//
+// The space that a leaf ends up in, for a given resource kind, is
+// the sum of two things along the chain from the root:
+//
+// * The `getBindingSpace(kind)` of each `VarLayout` on the chain.
+//   This is usually zero, except for global-scope parameters that
+//   were given an explicit space (e.g., `register(t0, space1)`).
+//
+// * The `getOffset(LayoutResourceKind::RegisterSpace)` of every
+//   `VarLayout` on the chain, and not just of those whose type
+//   is itself a parameter group that allocates a space (see
+//   below).
+//
+// The second rule matters for aggregates that *contain* such
+// groups. Given:
+//
+//      struct S { ParameterBlock<A> a; ParameterBlock<B> b; }
+//      S gS;
+//
+// the variable `gS` is not a parameter group, but it consumes
+// two spaces, and its `RegisterSpace` offset says where the
+// first of them starts. The field `b` has a `RegisterSpace`
+// offset of one, relative to `S`, so the contents of `gS.b` end
+// up in the space given by the offset of `gS` plus one. Skipping
+// the offset of `gS`, because its type is a plain `struct`, would
+// put `gS.b` in the wrong space.
+//
+// When *Not* to Accumulate
+// ------------------------
+//
+// Simply summing offsets stops being correct whenever the chain
+// steps into a parameter group, because the group's contents live
+// somewhere new. There are two cases:
+//
+// * Every parameter group (`ConstantBuffer`, `ParameterBlock`, etc.)
+//   puts the ordinary data of its element in a buffer of its own.
+//   The accumulated `Bytes` offset therefore restarts at zero inside
+//   the group, rather than continuing from the offset of the group.
+//
+// * Some parameter groups also allocate a space of their own. This
+//   is the case for a `ParameterBlock` on D3D12 and Vulkan, and the
+//   way to tell is that the type layout of the group consumes
+//   `LayoutResourceKind::RegisterSpace`. Inside such a group, every
+//   index-based resource kind (`register`s and `binding`s) restarts
+//   at zero, relative to the newly allocated space, and the space is
+//   accumulated as described above.
+//
+// A `ConstantBuffer` does *not* allocate a space, so the `binding`s
+// of its contents continue to accumulate from the `binding` of the
+// buffer, via the element variable layout. That is the `gBuffer.t`
+// case above: `10` from `gBuffer`, plus `1` from the element layout
+// (which accounts for the buffer itself), plus `0` from `t`.
+//
+// Stepping into an element of an array adds `index * stride` for
+// each resource kind that the array lays out as consecutive slots
+// (always `Bytes`, and `register`s on D3D). On Vulkan, an array of
+// resources is a single `binding` with a descriptor count, so the
+// `binding` stays the same, and the element index instead feeds
+// into an array index, linearized as described for shader cursors
+// in the next document.
+//
+
+//
+// Flattened Leaf Fields
+// ---------------------
+//
+// Accumulating offsets is something that almost every application
+// needs to do, and getting the rules for parameter groups right is
+// subtle enough that many applications get it wrong. Applications
+// that just want to know "where does each leaf value go?" can
+// instead ask a type layout for a pre-accumulated table:
+//
+enum class LeafFieldKind
+{
+    // An actual leaf: a field of non-`struct`, non-group type,
+    // or an array (see below).
+    //
+    Leaf,
+
+    // A parameter group (`ConstantBuffer`, `ParameterBlock`, ...)
+    // that the walk descended into. Its offsets describe the
+    // group itself (e.g., the `binding` of a constant buffer),
+    // and the leaves inside it refer back to it via `bufferIndex`.
+    //
+    ParameterGroup,
+};
+
+struct LeafFieldInfo
+{
+    // Whether this entry is a leaf, or a parameter group that
+    // contains further entries. Code that only wants to iterate
+    // the values to write should skip `ParameterGroup` entries.
+    //
+    LeafFieldKind       kind;
+
+    // The path from the root type to this entry, as a sequence
+    // of field indices.
+    //
+    Sequence<Index>     path;
+
+    // The leaf type layout, and the variable layout of the
+    // innermost field, if any.
+    //
+    TypeLayout*         leafTypeLayout;
+    VarLayout*          leafVarLayout;
 
-// TODO: how to accumulate spaces?
+    // The offset and space of this entry for each resource kind,
+    // accumulated from the root according to the rules above
+    // (including the restarts described under "When *Not* to
+    // Accumulate"), and so relative to the buffer or space that
+    // actually holds the entry.
+    //
+    Offset              getOffset(LayoutResourceKind kind);
+    Index               getBindingSpace(LayoutResourceKind kind);
+
+    // The index, in the same table, of the innermost parameter
+    // group that contains this leaf, or `-1` if the leaf is not
+    // nested in a parameter group within the root type.
+    //
+    Index               bufferIndex;
+};
+
+extension TypeLayout
+{
+    Sequence<LeafFieldInfo> getLeafFields();
+}
+
+//
+// The table is produced by a walk that descends through `struct`
+// fields and through the element of each parameter group, and
+// applies the rules described above:
+//
+// * Offsets and spaces from each `VarLayout` along the path are
+//   summed, per resource kind.
+//
+// * When the walk descends into a parameter group, the offsets
+//   from its `getElementVarLayout()` are used, rather than those
+//   of its `getContainerVarLayout()`. This is what puts `gBuffer.t`
+//   at `binding=11` in the earlier example.
+//
+// * `Bytes` restarts at zero inside every parameter group, since
+//   its contents live in a separate buffer.
+//
+// * Index-based kinds (`register`s and `binding`s) restart at zero
+//   only inside a parameter group that allocates its own space
+//   (e.g., a `ParameterBlock` on Vulkan), and the entries inside
+//   report that new space from `getBindingSpace`. Inside a
+//   `ConstantBuffer` they keep accumulating in the same space.
+//
+// * `RegisterSpace` itself always accumulates.
+//
+// * The parameter group itself gets an entry of kind
+//   `ParameterGroup`, whose own offsets come from its container
+//   variable layout, so that leaves can find their buffer through
+//   `bufferIndex`.
+//
+// Arrays are treated as leaves: an array of `float4`s or of
+// `Texture2D`s is one entry, and the application uses the stride
+// (or the array index within a binding range) to address
+// elements. Expanding every element of every array would make
+// the table unboundedly large.
+//
+// The table is computed the first time it is requested, and then
+// cached on the type layout, so per-frame code that iterates it
+// does not walk the layout tree at all.
+//
+// Resolving a Single Binding
+// --------------------------
+//
+// The table above is the right tool when an application wants
+// *all* the leaves. More often, an application wants the final
+// `binding` and `set` for one specific parameter, given by
+// a path like `gBuffer.t` or `gMaterials[3].diffuseMap`:
+//
+struct ResolvedBinding
+{
+    Index space;        // D3D12 `space`, Vulkan `set`
+    Index index;        // D3D `register`, Vulkan `binding`
+    Index arrayIndex;   // index within an arrayed binding, or zero
+};
+
+extension ProgramLayout
+{
+    SlangResult resolveBinding(
+        const char*         path,
+        LayoutResourceKind  kind,
+        ResolvedBinding*    outBinding);
+}
+
+//
+// Resolution walks the path one step at a time, applying the
+// rules for accumulating indices and spaces given above: using
+// the element rather than container layout when stepping into a
+// parameter group, restarting indices in a fresh space when the
+// group allocates one, and turning array subscripts into either
+// a slot offset or an `arrayIndex`. It costs time proportional to
+// the depth of the path rather than the size of the program. The
+// `kind` identifies which resource kind's offsets to follow,
+// since a single path may consume several (e.g., a `t` register
+// and an `s` register on D3D).
+//
+// Applications that bind the same parameters every frame can
+// parse a path once, into a handle that can then be resolved
+// against any number of programs:
+//
+class BindingPath
+{
+    SlangResult resolve(
+        ProgramLayout*      program,
+        LayoutResourceKind  kind,
+        ResolvedBinding*    outBinding);
+};
+
+BindingPath* createBindingPath(
+    const char* path,
+    IBlob**     outDiagnostics = nullptr);
+
+//
+// A `BindingPath` is immutable once created, so it may be shared
+// freely between threads, and it holds no references to (or data
+// from) any program or session. It stores the path already parsed,
+// with each subscript as an integer, and each field name as its
+// text together with a hash of that text computed up front.
+//
+// Resolution works purely at the layout level, so that it gives
+// the same answer for a `ProgramLayout` that was opened from a
+// `LayoutSnapshot`, which has neither a `Session` (and so no
+// interned `Name`s) nor an `AggType` to look fields up in. Each
+// step looks the field up by name on the layout itself:
+//
+extension StructTypeLayout
+{
+    // Returns the index in `getFields()` of the field with the
+    // given name, or `-1` if there is none.
+    //
+    Index findFieldIndexByName(const char* name);
+    Index findFieldIndexByName(const char* name, HashCode nameHash);
+}
+//
+// (The first step of a path uses the same kind of lookup over
+// the global parameters of the `ProgramLayout`.)
+//
+// The index behind `findFieldIndexByName` maps the hash of each
+// field name to the field's index, and a hit is confirmed by
+// comparing the text. It is built from the field names stored
+// with the layout (the string table, in a snapshot) the first
+// time the `struct` is asked, and cached with publish-once
+// semantics, in the side table of the `LayoutSnapshot` for a
+// snapshot. A `BindingPath` passes its precomputed hashes, so
+// resolving it does no parsing or string hashing, and still
+// costs only O(depth).
+//
 
 //
 // Examples / Recipes
@@ -724,3 +724,8 @@ struct SubObjectRangeInfo
 // and feedback are welcome.
 //
 
+// The next document steps back from *what* the reflection
+// API exposes, and looks at what it costs an application
+// to get at that information.
+
+#include "slang-reflection-part4.h"
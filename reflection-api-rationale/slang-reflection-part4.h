@@ -0,0 +1,737 @@
+// slang-reflection-part4.h
+
+// Reflection as Data
+// ==================
+//
+// The previous documents have been concerned with *what*
+// information the reflection API exposes, and have mostly
+// ignored the question of what it costs to get at that
+// information.
+//
+// In practice, applications that ship many shader permutations
+// care a lot about that cost. An engine with thousands of
+// permutations does not want to run the front-end of the
+// compiler (`loadModule`, `link`, `specializeProgram`) at
+// every startup, just to recover layout information that
+// was already computed when the shaders were built offline.
+//
+// This document collects the parts of the API that exist
+// primarily to make reflection *cheap*, rather than to
+// expose new information.
+//
+// Layout Snapshots
+// ================
+//
+// A key observation is that once a `TargetProgram` has been
+// created, everything at the layout level is plain data:
+// sizes, offsets, binding ranges, descriptor sets, and so on.
+// None of it needs the semantic checker to answer queries.
+//
+// We therefore propose that a `TargetProgram` can be written
+// out as a *snapshot*:
+//
+extension TargetProgram
+{
+    SlangResult writeLayoutSnapshot(IBlob** outSnapshot);
+};
+//
+// and that a snapshot can later be loaded back *without*
+// going through a `Session` at all:
+//
+class LayoutSnapshot
+{
+    ProgramLayout* getProgramLayout();
+};
+
+LayoutSnapshot* openLayoutSnapshot(
+    void const* data,
+    Size        size,
+    IBlob**     outDiagnostics = nullptr);
+
+//
+// The `data` passed to `openLayoutSnapshot` is expected to
+// stay alive (and unchanged) for as long as the snapshot is
+// in use. The intention is that an application can `mmap`
+// a file and hand the mapped range directly to Slang.
+//
+// The `ProgramLayout` that comes back from a snapshot is
+// queried through exactly the same API as one that came
+// from `Target::specializeProgram`. Application code that
+// walks `TypeLayout`s, `VarLayout`s, `BindingRangeInfo`s,
+// `DescriptorSetInfo`s, and `EntryPointLayout`s should not
+// need to know which of the two it is dealing with.
+//
+// Implementation Notes
+// --------------------
+//
+// For opening a snapshot to be (close to) free, the format
+// needs to be queryable *in place*. That rules out any format
+// that requires a deserialization pass to rebuild a pointer
+// graph. Instead:
+//
+// * All references between layout objects are stored as
+//   offsets relative to the start of the snapshot, so that
+//   the data is position-independent and can be mapped at
+//   any address.
+//
+// * Each `Sequence<T>` is stored as an (offset, count) pair
+//   referring to a contiguous array in the snapshot.
+//
+// * All strings are stored once, in a single string table,
+//   and referred to by offset.
+//
+// * The "objects" returned by the API (e.g., a `TypeLayout*`)
+//   are pointers *into* the mapped data, and the query methods
+//   decode the fields they need on demand.
+//
+// The last point is where the pseudo-code in these documents
+// is hiding real work: an actual C/C++ API would need the
+// layout classes to be thin views over a flat representation
+// (which is, incidentally, also how they are likely to be
+// exposed over a C ABI anyway).
+//
+// What a Snapshot Does Not Contain
+// --------------------------------
+//
+// A snapshot deliberately stops at the layout level. Queries
+// that would reach back into the `Entity` level (e.g.,
+// `TypeLayout::getType()` or `BindingRangeInfo::leafVar`)
+// cannot return a full `Type*` or `Var*`, because there is
+// no AST behind the snapshot.
+//
+// Rather than return null from such queries, a snapshot
+// answers them with lightweight entities that only support
+// the name queries on `Entity` (and `getUserAttributes()`,
+// whose data is small enough to copy into the snapshot).
+// Anything beyond that requires loading the program the
+// normal way.
+//
+// Similarly, compiled kernel code for the entry points is
+// *not* part of a snapshot. Applications already have their
+// own caching for compiled code, and coupling the two would
+// make snapshots much larger than they need to be.
+//
+// Versioning
+// ----------
+//
+// A snapshot records the compiler version that produced it,
+// along with a format version. `openLayoutSnapshot` fails
+// (with a diagnostic) if it is handed a snapshot that it
+// cannot read, rather than trying to interpret it.
+//
+// Snapshots are a cache, not an interchange format, so we
+// do not promise that a newer compiler can read snapshots
+// from an older one. See `versioning.md` for how this fits
+// into our broader story on binary compatibility.
+//
+// Validation
+// ----------
+//
+// Because queries decode offsets straight out of the mapped
+// data, a truncated or corrupted file would otherwise turn
+// into out-of-bounds reads. We do *not* ask applications to
+// trust snapshot data; instead `openLayoutSnapshot` validates
+// it once, up front, and fails with a diagnostic if anything
+// is wrong:
+//
+// * The header records the total size of the snapshot, and a
+//   checksum of everything after the header. A `size` that
+//   doesn't match, or a checksum that doesn't, is rejected.
+//
+// * Every table (layout objects, sequences, the string table)
+//   is then checked once: each stored offset and (offset, count)
+//   pair must lie within `size`, each string must be terminated
+//   within the string table, and each enum-valued field must be
+//   in range.
+//
+// Validation is a single linear pass over the data, which is
+// cheap next to the front-end work a snapshot replaces. Once a
+// snapshot has been opened, queries on it do no further bounds
+// checks. (The checksum guards against accidental damage, not
+// against a deliberately crafted file; the table checks are what
+// keep reads in bounds either way.)
+//
+// Concurrent Reads
+// ================
+//
+// Applications increasingly want to query reflection data from
+// multiple threads at once (e.g., one per render thread, each
+// filling in its own descriptor sets). If every query has to
+// take a lock, the reflection API becomes a point of contention
+// for work that is, logically, entirely read-only.
+//
+// We therefore make the following guarantee:
+//
+// * Once `Target::specializeProgram` has returned a `TargetProgram`,
+//   the layout objects reachable from it (`ProgramLayout`,
+//   `EntryPointLayout`, `TypeLayout`, `VarLayout`, and so on)
+//   are immutable, and any of the queries in these documents
+//   may be called on them from any number of threads at once,
+//   without external synchronization.
+//
+// The same holds for the layout objects in a `LayoutSnapshot`,
+// whose data is never written after the snapshot is opened.
+//
+// Immutable does not quite mean that nothing is ever written.
+// Several queries are answered from data that is computed the
+// first time it is asked for, and then cached: binding ranges,
+// descriptor sets, indices for looking up fields by name, etc.
+// Each such cache is written at most once, with publish-once
+// semantics:
+//
+// * A thread that finds the cache empty computes the result
+//   into freshly-allocated storage, and then attempts to
+//   install it with a single compare-and-swap.
+//
+// * If the compare-and-swap fails, another thread got there
+//   first; the losing thread discards its result and uses
+//   the one that was installed.
+//
+// * Readers that find the cache populated just use it, with
+//   an acquire load and no other synchronization.
+//
+// Two threads may thus occasionally duplicate the work of
+// filling in a cache, but no thread ever blocks, and every
+// thread sees the same result. Because the results are
+// deterministic, it doesn't matter which thread "wins".
+//
+// For a layout snapshot, there is nowhere in the data itself to
+// put such a cache: the data may be a read-only mapping, and
+// must not be modified in any case. The `LayoutSnapshot` instead
+// owns a *side table* for each kind of lazily-computed data,
+// keyed by the offset of the layout object within the snapshot.
+// Each side-table slot is installed with the same publish-once
+// compare-and-swap as above, and is freed along with the
+// `LayoutSnapshot`. Where the data is cheap to store, the writer
+// can also precompute it into the snapshot (e.g., binding ranges
+// and descriptor sets are always written out), in which case the
+// side table is never consulted for it.
+//
+// Note that this guarantee covers the layout level only.
+// Operations at the `Entity` level that may trigger semantic
+// checking (e.g., `Generic::specialize` or `Program::findEntity`)
+// mutate shared state in the `Session`, and are serialized by a
+// per-session lock rather than running concurrently (see the
+// discussion of `specializeProgramAsync` in the first document).
+//
+// Lifetimes and Memory
+// ====================
+//
+// These documents have so far been silent on who owns the objects
+// that the reflection API returns. The current API is similarly
+// vague, and in practice each layout object is a separate heap
+// allocation with its own reference count.
+//
+// We propose a simpler rule for the layout level:
+//
+// * Every layout object reachable from a `TargetProgram` (including
+//   the storage behind any `Sequence<T>` returned by a query) is
+//   owned by that `TargetProgram`, or by its `Target` in the case
+//   of shared type layouts, and remains valid at least as long as
+//   the `TargetProgram` does.
+//
+// * Layout objects are not reference-counted individually. Holding
+//   a `TypeLayout*` does not keep anything alive; an application
+//   that wants to keep layout information around must keep the
+//   `TargetProgram` (or `LayoutSnapshot`) around.
+//
+// Given that rule, the implementation is free to allocate all of
+// the layout objects for a `TargetProgram` out of a single arena
+// owned by the program, with simple bump-pointer allocation.
+// Objects that are created together (e.g., a `StructTypeLayout`
+// and the `VarLayout`s for its fields) end up next to one another
+// in memory, which helps traversals, and releasing a program
+// frees the whole arena at once rather than object-by-object.
+// The lazily-computed caches described above are allocated from
+// the same arena (with a thread-safe bump allocator), so they
+// don't escape the rule.
+//
+// Type layouts that are shared across programs (see the discussion
+// of `Target::getEntityLayout` in the first document) are allocated
+// the same way, from per-module arenas owned by the `Target`,
+// which are freed when the corresponding module is released.
+//
+// The `Entity` level can't use per-program arenas, since an
+// `Entity` is shared by every program that refers to it (that
+// is the whole point of caching specializations). Nor can it
+// simply live as long as the `Session`: an editor that reloads
+// modules and specializes many generics over a long session
+// would then accumulate every `Entity` it has ever created.
+//
+// Instead, `Entity`-level data is owned per module, following
+// the same rules as the shared layout cache on `Target`:
+//
+// * Each `Entity` (along with everything cached on it, such as
+//   its fully-qualified name, name indexes, child lists, and
+//   decoded attribute arguments) belongs to one module, and is
+//   allocated from an arena the session keeps for that module.
+//   A plain declaration belongs to the module that declares it.
+//   A specialization belongs to whichever of the modules its
+//   generic and arguments refer to comes last in import order,
+//   the same owner that is chosen for shared layouts.
+//
+// * Entries in the specialization cache, the `findEntity`
+//   caches, and the session's name-lookup tables that refer to
+//   an `Entity` are keyed (directly or through its arguments)
+//   on the modules involved. When a module is released, every
+//   entry that refers to it is removed, so it can no longer be
+//   found, and the module's arena is freed.
+//
+// * An `Entity` stays valid as long as every module it refers
+//   to is alive. Applications normally keep modules alive by
+//   holding a `Program` linked from them, since a `Program`
+//   keeps its modules alive.
+//
+// Interned `Name`s are the one exception: a `Name` is only a
+// string, does not refer to any module, and is kept for the
+// life of the session. The name table is bounded by the set
+// of distinct names that have been interned (including the
+// fully-qualified names of any specializations that were asked
+// for them), which does not grow when the same source is
+// reloaded again and again.
+//
+// Once ownership is tied to a handful of long-lived objects, it
+// also becomes possible to tell an application how much memory
+// each of them is holding on to. Large applications (e.g., an
+// editor that keeps many sessions and programs alive) need this
+// both to set budgets and to find leaks.
+//
+enum class MemoryCategory
+{
+    AST,                // declarations, and `Entity`s wrapping them
+    IR,                 // linked and target-specific IR
+    Layout,             // `TypeLayout`s, `VarLayout`s, etc.
+    BindingRanges,      // binding range, descriptor set, and sub-object tables
+    Code,               // compiled kernel code blobs
+    Other,
+};
+
+struct MemoryUsage
+{
+    Size    byteCount;
+    Count   objectCount;
+
+    // The largest `byteCount` seen for this category over
+    // the lifetime of the object being reported on.
+    //
+    Size    peakByteCount;
+};
+
+struct MemoryReport
+{
+    // Indexed by `MemoryCategory`.
+    //
+    MemoryUsage categories[Count(MemoryCategory::Other) + 1];
+
+    // The sums of `byteCount` and `objectCount` over all the
+    // categories. Note that `total.peakByteCount` is the peak
+    // of the *sum* (the most memory the object ever held at
+    // one time), which is generally less than the sum of the
+    // per-category peaks, since different categories tend to
+    // peak at different times.
+    //
+    MemoryUsage total;
+};
+
+extension Session       { void getMemoryReport(MemoryReport* outReport); }
+extension Module        { void getMemoryReport(MemoryReport* outReport); }
+extension Program       { void getMemoryReport(MemoryReport* outReport); }
+extension TargetProgram { void getMemoryReport(MemoryReport* outReport); }
+extension Target        { void getMemoryReport(MemoryReport* outReport); }
+
+//
+// Each object only reports the memory that it *owns*, per the
+// rules above, so that reports for different objects can be
+// summed without double-counting. In particular, a `Module`
+// reports its AST and IR, while the `Entity`s created by
+// specializing the module's generics are reported by the
+// `Session`, and the layouts for a program are reported by the
+// `TargetProgram` rather than the `Program` (except for shared
+// type layouts, which are reported by the `Target`).
+//
+// The counts are maintained as allocations happen, so asking
+// for a report does not walk anything:
+//
+// * `objectCount` is incremented on every object allocation,
+//   including allocations from an arena. For a bump allocator
+//   this is one non-atomic increment of a per-arena, per-category
+//   counter (or an atomic one, for arenas that are allocated from
+//   concurrently), which is small next to the allocation itself.
+//
+// * `byteCount` for an arena-backed category is updated only when
+//   the arena grabs a new block, so it is the size of the blocks
+//   the arena has allocated, which may be somewhat larger than the
+//   sum of the objects in it.
+//
+// * Peaks are updated whenever a byte count grows, for each
+//   category and for the total.
+//
+// Because arenas release all of their objects at once, the counts
+// for an arena only ever drop back to zero, when its owner is
+// released.
+//
+// Bulk Field Access
+// =================
+//
+// Code that walks all of the fields of a `struct` (e.g., to copy
+// ordinary data from an application object into a constant buffer)
+// currently calls `getFields()`, and then `getOffset()` and
+// `getTypeLayout()` on each `VarLayout`. Each step follows a pointer
+// to a separate object, even though the application only wants a
+// few numbers per field.
+//
+// A `StructTypeLayout` can instead expose its per-field data as a
+// table of parallel arrays, each with one entry per field:
+//
+struct StructFieldTable
+{
+    Count                     fieldCount;
+
+    // `Bytes` offset and size of each field.
+    //
+    Offset const*             byteOffsets;
+    Size const*               byteSizes;
+
+    // Offset of each field, in binding ranges, as would be
+    // returned by `getBindingRangeOffsetForField`.
+    //
+    Count const*              bindingRangeOffsets;
+
+    // The type layout of each field.
+    //
+    TypeLayout* const*        fieldTypeLayouts;
+
+    // Offsets for resource kinds other than `Bytes`, stored as
+    // one array per kind that the `struct` consumes. The kinds
+    // are listed in `resourceKinds`, and the offsets of field `f`
+    // for `resourceKinds[k]` are at `resourceOffsets[k][f]`.
+    //
+    Count                     resourceKindCount;
+    LayoutResourceKind const* resourceKinds;
+    Offset const* const*      resourceOffsets;
+};
+
+extension StructTypeLayout
+{
+    StructFieldTable getFieldTable();
+}
+
+//
+// The table doesn't add any information that wasn't available
+// before; entry `i` of each array agrees with what the queries on
+// `getFields()[i]` would return. The point is purely the shape of
+// the data: a loop over `byteOffsets` and `byteSizes` touches two
+// contiguous arrays, rather than two objects per field.
+//
+// The arrays are owned by whoever owns the `StructTypeLayout`
+// (its `Target`, for a shared type layout, per the lifetime rules
+// above), and are built as part of laying out the `struct`,
+// so `getFieldTable()` itself is just a few loads.
+//
+// A layout snapshot can only store part of the table directly.
+// The arrays of plain values (`byteOffsets`, `byteSizes`,
+// `bindingRangeOffsets`, `resourceKinds`, and the per-kind arrays
+// of offsets) are written into the snapshot data, and the table
+// points straight at them. The two arrays of *pointers* cannot
+// be: `fieldTypeLayouts` holds the addresses of `TypeLayout`s,
+// and the outer array of `resourceOffsets` holds the addresses of
+// the per-kind arrays, neither of which is known until the data
+// is mapped. (The snapshot stores the corresponding offsets.)
+// The first call to `getFieldTable()` on a `StructTypeLayout` in
+// a snapshot builds those two arrays, by adding the base address
+// of the mapping to each stored offset, into the snapshot's side
+// table for that `struct` (with publish-once semantics, as
+// described under "Concurrent Reads"). Later calls return the
+// same arrays, which are freed along with the `LayoutSnapshot`.
+//
+// Bulk Export
+// ===========
+//
+// Some applications don't want to query reflection data at all
+// at runtime; they want to dump all of it, for every permutation,
+// into their own asset pipeline. Doing that through the query API
+// means many thousands of calls per program, most of which just
+// copy a field into some other format.
+//
+// For these cases, a `TargetProgram` can write out its entire
+// reflection graph in one call:
+//
+enum class ReflectionExportFormat
+{
+    Binary,
+    JSON,
+};
+
+class IReflectionSink
+{
+    // Called repeatedly with consecutive chunks of the output.
+    // Returning a failure result stops the export.
+    //
+    SlangResult write(void const* data, Size size);
+};
+
+extension TargetProgram
+{
+    SlangResult exportReflection(
+        ReflectionExportFormat  format,
+        IReflectionSink*        sink);
+}
+
+//
+// The export covers everything reachable from the program:
+// the entities that layouts refer to, type and variable layouts,
+// binding ranges, descriptor sets, sub-object ranges, and the
+// entry points.
+//
+// The output is produced in a single depth-first walk, and handed
+// to the sink in fixed-size chunks as it is produced, so the
+// export never builds the whole output in memory. Each distinct
+// type layout is written once, the first time it is reached, and
+// referred to by a numeric ID after that.
+//
+// IDs are assigned sequentially, in the order the walk first
+// writes each object, starting from zero. The walk itself visits
+// parameters, fields, and entry points in their declared order,
+// so exporting the same program twice produces byte-for-byte
+// the same output, and so does exporting two programs whose
+// layouts are the same, however their layout objects happen to
+// be laid out in memory. (IDs derived from an object's address,
+// or from its position within an arena, would not have that
+// property: the contents of a `Target`'s shared arenas depend on
+// which programs were laid out before, and in what order, and a
+// publish-once race can leave a discarded result in an arena.)
+//
+// The cost is a table from layout objects to the IDs assigned so
+// far, with one entry per distinct object written. The memory the
+// export needs is thus its chunk buffer, the walk's stack, and
+// that table. This grows with the number of distinct layout
+// objects reachable from the program, but not with the size of
+// the output, and is small next to the layouts themselves.
+//
+// The first record in the stream (in either format) identifies the
+// format and its version, along with the compiler version that
+// produced it, so that offline tools can reject streams they don't
+// understand instead of misparsing them. As with snapshots, we
+// don't promise compatibility across versions of the format.
+//
+// The binary format here is *not* the same as a layout snapshot.
+// A snapshot is designed to be queried in place, which requires
+// knowing where everything will go before it is written; the
+// export format is a simple stream of tagged records instead, which
+// is cheap to produce and easy for an offline tool to parse.
+// The JSON format contains the same records, and is intended for
+// debugging and for tools where convenience matters more than size.
+//
+// Comparing Layouts
+// =================
+//
+// After a shader edit (see "Reloading Modules" in the first
+// document), an application needs to decide what to rebuild:
+// pipeline layouts, descriptor set layouts, CPU-side code that
+// fills in constant buffers, and so on. Each of those depends on
+// a different part of the layout, and most edits don't change
+// most of them.
+//
+// We therefore provide a structural comparison of two layouts:
+//
+enum class LayoutChangeKind
+{
+    FieldAdded,
+    FieldRemoved,
+    FieldTypeChanged,
+    OffsetChanged,          // for any `LayoutResourceKind`
+    SizeChanged,            // for any `LayoutResourceKind`
+    BindingRangesChanged,
+    DescriptorSetsChanged,
+    EntryPointAdded,
+    EntryPointRemoved,
+};
+
+struct LayoutChange
+{
+    LayoutChangeKind    kind;
+
+    // For a diff of two `ProgramLayout`s, the index of the entry
+    // point whose parameters changed (in the new layout, or in the
+    // old one for a removed entry point), or `-1` for a change to
+    // the global parameters. Always `-1` for a diff of two
+    // `TypeLayout`s.
+    //
+    Index               entryPointIndex;
+
+    // Path of field indices from the root to the node that
+    // changed, in the *new* layout (or in the old layout, for
+    // `FieldRemoved`). Empty for `EntryPointAdded` and
+    // `EntryPointRemoved`, which apply to the whole entry point.
+    //
+    Sequence<Index>     path;
+
+    // The resource kind affected, for `OffsetChanged` and
+    // `SizeChanged`.
+    //
+    LayoutResourceKind  resourceKind;
+};
+
+class LayoutDiff
+{
+    Sequence<LayoutChange> getChanges();
+};
+
+LayoutDiff* diffLayouts(
+    TypeLayout* oldLayout,
+    TypeLayout* newLayout);
+
+LayoutDiff* diffLayouts(
+    ProgramLayout* oldLayout,
+    ProgramLayout* newLayout);
+
+//
+// Fields are matched up by name rather than by index, so that
+// inserting a field into a `struct` reports one `FieldAdded`
+// (along with an `OffsetChanged` for any field that moved)
+// rather than a change to every subsequent field. For a
+// `ProgramLayout`, the global parameters and each entry point
+// are compared in the same way; entry points are matched up by
+// name, and `entryPointIndex` says which one a change belongs
+// to, so that its `path` is always relative to the parameters
+// of that entry point (or to the global parameters).
+//
+// An entry point that exists in only one of the two layouts is
+// reported as a single `EntryPointAdded` (with `entryPointIndex`
+// in the new layout) or `EntryPointRemoved` (with the index in the
+// old layout), and its parameters are not compared any further.
+//
+// A diff doesn't belong to either of the layouts it compares
+// (which may come from different programs, or even a program and
+// a snapshot), so it is returned as a `LayoutDiff` object of its
+// own. The changes, and the storage behind their paths, are
+// allocated from an arena owned by the `LayoutDiff`, and stay
+// valid until the application releases it.
+//
+// The comparison should be fast when (as is typical) almost
+// nothing has changed. Each layout node has a *structural hash*,
+// which covers everything that `diffLayouts` compares about the
+// node and all of its descendants:
+//
+// * The hash of a `TypeLayout` covers its sizes, alignments, and
+//   fields (including the hashes of the field `VarLayout`s).
+//
+// * The hash of a `VarLayout` covers its offset and space for each
+//   resource kind, along with the hash of its type layout. Since
+//   an `EntryPointLayout` (and a `ProgramLayout`) is a `VarLayout`,
+//   this also gives each entry point a hash that covers both the
+//   offsets of the entry point as a whole and all of its parameters.
+//
+// These hashes are computed bottom-up when the layout is created,
+// so they cost nothing extra to query.
+//
+// When two nodes being compared have equal hashes, the whole
+// subtree is skipped without being visited, so the cost of a
+// diff is proportional to the parts that changed, rather than
+// the size of the layouts.
+//
+// (A hash collision would cause a real change to be missed, so
+// the structural hash needs to be wide enough that this is not a
+// practical concern; 128 bits is more than sufficient.)
+//
+// `TargetProgram::getEntryPointsChangedSince` is then just a
+// matter of checking, per entry point, whether this diff would be
+// empty, which reduces to comparing the structural hashes of the
+// two `EntryPointLayout`s.
+//
+// Structural Hashes
+// -----------------
+//
+// The structural hashes used by `diffLayouts` are useful on their
+// own. An application that creates API objects from layouts (e.g.,
+// a `VkDescriptorSetLayout` per `DescriptorSetInfo`) will find that
+// most permutations of a shader produce identical layouts, and
+// wants to share those objects across permutations without having
+// to compare layouts by hand.
+//
+struct LayoutHash
+{
+    UInt64 low;
+    UInt64 high;
+};
+
+extension TypeLayout
+{
+    // Hash of everything `diffLayouts` compares, for this type
+    // layout and everything it contains.
+    //
+    LayoutHash getStructuralHash();
+
+    // Hash of the binding ranges and descriptor sets only
+    // (i.e., of `getBindingRanges()` and `getDescriptorSets()`).
+    //
+    LayoutHash getBindingRangesHash();
+
+    // Hash of the descriptor set `getDescriptorSets()[setIndex]`.
+    //
+    LayoutHash getDescriptorSetHash(Index setIndex);
+}
+
+extension VarLayout
+{
+    // Hash of the offsets and spaces of this variable, for every
+    // resource kind, together with the structural hash of its
+    // type layout. This is also the hash of an `EntryPointLayout`
+    // or `ProgramLayout`.
+    //
+    LayoutHash getStructuralHash();
+}
+
+//
+// The hashes are *stable*: they are computed only from the
+// contents of the layout (sizes, offsets, binding types, and
+// so on), never from pointers or from the order in which objects
+// were created. Two equal layouts thus hash the same in different
+// runs, in different processes, and whether they come from a
+// `TargetProgram` or from a layout snapshot, so an application can
+// use them as keys in a persistent cache.
+//
+// What counts as "equal" depends on the hash:
+//
+// * The hash of a `TypeLayout` includes the names of fields
+//   and the fully-qualified names of the types involved, since
+//   renaming a field matters to code that looks it up by name.
+//
+// * The hash of a descriptor set, and the hash of the binding
+//   ranges, include only what a GPU API would see: binding types,
+//   counts, and offsets. Two differently-named `struct`s that need
+//   the same descriptor set layout get the same hash.
+//
+// * The hash of a descriptor set covers its descriptor ranges,
+//   but *not* its `spaceOffset`. The same `set` layout may be
+//   bound at a different `set` index in different programs (e.g.,
+//   a material's parameter block), and a `VkDescriptorSetLayout`
+//   doesn't depend on which index it is bound at.
+//
+// The structural hash of a `TypeLayout` is computed eagerly, when
+// the layout is created, but it does *not* require binding ranges
+// or descriptor sets to be built: those are derived deterministically
+// from the type's fields, their per-kind offsets, and the kinds of
+// resources at the leaves, all of which the structural hash already
+// covers. Equal structural hashes thus imply equal binding ranges,
+// which is what lets `diffLayouts` skip them.
+//
+// The binding-range hash and the descriptor-set hashes, on the
+// other hand, deliberately ignore names, so they can only be
+// computed from the binding ranges and descriptor sets themselves.
+// `DescriptorSetInfo` is a plain value, returned by copy, with
+// nowhere to cache a hash, which is why the descriptor-set hash is
+// a query on the `TypeLayout` that owns the sets, by index.
+// They are computed lazily, the first time they are asked for
+// (which forces the binding ranges and descriptor sets to be built,
+// if they haven't been already), and installed with the same
+// publish-once semantics as the other lazily-computed data (in a
+// single array on the `TypeLayout`, one entry per set). In a
+// layout snapshot, they are precomputed along with the binding
+// ranges and descriptor sets.
+//
+// The hash function itself is part of the compiler, and we do not
+// promise that the same layout hashes the same across compiler
+// versions; caches keyed on these hashes should also key on the
+// compiler version.
+//